@@ -0,0 +1,95 @@
+/**
+ * 步进性能测试程序，仅使用对外函数接口，可直接用于对比不同版本
+ * 编译: gcc -O2 -std=c99 benchmark.c simple_stateflow.c -o benchmark
+ * 运行: ./benchmark [步进轮数]
+ * 缓存缺失统计:
+ *  perf stat -e cache-misses,cache-references ./benchmark
+ *  valgrind --tool=cachegrind ./benchmark 20
+ */
+
+#include <time.h>
+
+#include "simple_stateflow.h"
+
+#define BENCHMARK_NUM_OF_STATE_FLOW 4096 // 状态机数量，总数据量远大于一级缓存
+#define BENCHMARK_NUM_OF_EXIT_EVENT 4    // 每个状态的出口事件数量
+#define BENCHMARK_DEFAULT_ROUNDS 2000    // 默认步进轮数，每轮所有状态机各执行一个步进周期
+
+void during_benchmark(stateflow_message_box_s_t *stateflow_msg)
+{
+    SSF_MSG->test = (int)((unsigned int)SSF_MSG->test * 1103515245u + 12345u);
+}
+bool guard_benchmark_0(stateflow_message_box_s_t *stateflow_msg)
+{
+    return (((unsigned int)SSF_MSG->test >> 16) & 0x0F) == 0;
+}
+bool guard_benchmark_1(stateflow_message_box_s_t *stateflow_msg)
+{
+    return (((unsigned int)SSF_MSG->test >> 16) & 0x0F) == 1;
+}
+bool guard_benchmark_2(stateflow_message_box_s_t *stateflow_msg)
+{
+    return (((unsigned int)SSF_MSG->test >> 16) & 0x0F) == 2;
+}
+bool guard_benchmark_3(stateflow_message_box_s_t *stateflow_msg)
+{
+    return (((unsigned int)SSF_MSG->test >> 16) & 0x0F) == 3;
+}
+
+bool (*const guard_benchmark[BENCHMARK_NUM_OF_EXIT_EVENT])(stateflow_message_box_s_t *stateflow_msg) = {
+    guard_benchmark_0, guard_benchmark_1, guard_benchmark_2, guard_benchmark_3};
+
+static stateflow_s_t benchmark_state_flow[BENCHMARK_NUM_OF_STATE_FLOW];
+
+int main(int argc, char *argv[])
+{
+    long rounds = BENCHMARK_DEFAULT_ROUNDS;
+    unsigned long number_of_switches = 0;
+    clock_t start;
+    double seconds;
+
+    if (argc > 1)
+        rounds = atol(argv[1]);
+
+    // 每个状态机所有状态均有4个出口事件，依次指向各个状态
+    for (int i = 0; i < BENCHMARK_NUM_OF_STATE_FLOW; i++)
+    {
+        if (SSF_Init(&benchmark_state_flow[i], TEST_1) != OK)
+            return 1;
+        benchmark_state_flow[i].message_box.test = i;
+
+        for (int state = TEST_1; state < NUM_OF_STATE; state++)
+        {
+            if (SSF_CreateState(&benchmark_state_flow[i], (stateflow_state_table_e_t)state,
+                                BENCHMARK_NUM_OF_EXIT_EVENT, false, STATE_METHOD_NULL, during_benchmark,
+                                STATE_METHOD_NULL) != OK)
+                return 1;
+            for (int event = 0; event < BENCHMARK_NUM_OF_EXIT_EVENT; event++)
+                if (SSF_StateAddExitEvent(&benchmark_state_flow[i], (stateflow_state_table_e_t)state,
+                                          (stateflow_state_table_e_t)(TEST_1 + (state + event) % (NUM_OF_STATE - 1)),
+                                          (uint8_t)event, guard_benchmark[event]) != OK)
+                    return 1;
+        }
+    }
+
+    // 所有状态机轮流步进
+    start = clock();
+    for (long round = 0; round < rounds; round++)
+    {
+        for (int i = 0; i < BENCHMARK_NUM_OF_STATE_FLOW; i++)
+        {
+            stateflow_state_table_e_t state_before_step = benchmark_state_flow[i].now_state;
+
+            SSF_Step(&benchmark_state_flow[i]);
+            if (benchmark_state_flow[i].now_state != state_before_step)
+                number_of_switches++;
+        }
+    }
+    seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("state flows:%d rounds:%ld steps:%.0f switches:%lu\r\n", BENCHMARK_NUM_OF_STATE_FLOW, rounds,
+           (double)BENCHMARK_NUM_OF_STATE_FLOW * rounds, number_of_switches);
+    printf("time:%.3fs %.1fns/step\r\n", seconds, seconds * 1e9 / ((double)BENCHMARK_NUM_OF_STATE_FLOW * rounds));
+
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "simple_stateflow.h"
+#include "simple_stateflow_simulate.h"
 
 void entry_test_1(stateflow_message_box_s_t *stateflow_msg)
 {
@@ -50,10 +51,70 @@ void during_test_3(stateflow_message_box_s_t *stateflow_msg)
     printf("%d\r\n", SSF_MSG->test);
 }
 
+void simulate_state_flow_create(stateflow_s_t *sim_state_flow)
+{
+    SSF_Init(sim_state_flow, TEST_1);
+    SSF_CreateState(sim_state_flow, TEST_1, 1, false, STATE_METHOD_NULL, STATE_METHOD_NULL, STATE_METHOD_NULL);
+    SSF_StateAddExitEvent(sim_state_flow, TEST_1, TEST_2, 0, guard_test_1_to_test_2);
+    SSF_CreateState(sim_state_flow, TEST_2, 1, false, STATE_METHOD_NULL, STATE_METHOD_NULL, STATE_METHOD_NULL);
+    SSF_StateAddExitEvent(sim_state_flow, TEST_2, TEST_1, 0, guard_test_2_to_test_1);
+}
+
+void simulate_demo(void)
+{
+    // 录制的test数据，一列
+    int test_column[10] = {0, 5, 2, 1, 5, 5, 1, 0, 5, 1};
+    const void *test_columns[1] = {test_column};
+    uint16_t test_column_size[1] = {sizeof(int)};
+    stateflow_simulate_field_s_t test_fields[1] = {SSF_SIMULATE_FIELD(test)};
+
+    stateflow_simulate_log_s_t test_log;
+    stateflow_s_t sim_state_flow[2] = {0};
+    stateflow_transition_record_s_t test_records[2][16];
+    stateflow_simulate_job_s_t test_jobs[2] = {0};
+    FILE *file;
+
+    // 生成输入记录文件
+    file = fopen("demo_log.ssf", "wb");
+    if (file == NULL)
+        return;
+    printf("%d\r\n", SSF_SimulateLogWrite(file, test_columns, test_column_size, 1, 10));
+    fclose(file);
+
+    // 映射输入记录文件，在两个状态机上以两个线程并行回放
+    printf("%d\r\n", SSF_SimulateLogMap(&test_log, "demo_log.ssf"));
+    for (int i = 0; i < 2; i++)
+    {
+        simulate_state_flow_create(&sim_state_flow[i]);
+        test_jobs[i].stateflow = &sim_state_flow[i];
+        test_jobs[i].log = &test_log;
+        test_jobs[i].first_tick = 0;
+        test_jobs[i].output = test_records[i];
+        test_jobs[i].output_size = 16;
+    }
+    printf("%d\r\n", SSF_SimulateBatch(test_jobs, 2, test_fields, 1, 2));
+    for (uint32_t i = 0; i < test_jobs[0].number_of_records; i++)
+        printf("tick:%u %u->%u\r\n", (unsigned)test_records[0][i].tick, test_records[0][i].from_state,
+               test_records[0][i].to_state);
+
+    // 写入结果文件
+    file = fopen("demo_result.ssr", "wb");
+    if (file != NULL)
+    {
+        printf("%d\r\n", SSF_SimulateResultWrite(file, test_records[0], test_jobs[0].number_of_records));
+        fclose(file);
+    }
+
+    SSF_SimulateLogUnmap(&test_log);
+}
+
 int main()
 {
     stateflow_s_t test_state_flow = {0};
 
+    // 状态数量超过256时在simple_stateflow.h中打开SSF_STATE_INDEX_16BIT，内部状态索引变为2字节
+    printf("state index size:%d\r\n", (int)sizeof(stateflow_state_index_t));
+
     printf("%d\r\n", SSF_Init(&test_state_flow, TEST_1));
 
     printf("%d\r\n",
@@ -67,6 +128,19 @@ int main()
     printf("%d\r\n",
            SSF_CreateState(&test_state_flow, TEST_3, 0, false, STATE_METHOD_NULL, during_test_3, STATE_METHOD_NULL));
 
+    // 以test取1到5的信箱作为有代表性的输入探索状态图
+    stateflow_message_box_s_t test_inputs[5] = {0};
+    stateflow_explore_report_s_t test_report;
+    for (int i = 0; i < 5; i++)
+        test_inputs[i].test = i + 1;
+    printf("%d\r\n", SSF_Explore(&test_state_flow, test_inputs, 5, &test_report));
+    printf("unreachable:%d dead end:%d cycle:%d shadowed:%d\r\n", test_report.number_of_unreachable_states,
+           test_report.number_of_dead_end_states, test_report.number_of_cycle_states,
+           test_report.number_of_shadowed_events_total);
+
+    // 离线仿真
+    simulate_demo();
+
     while (1)
     {
         printf("=========================\r\n");
@@ -2,8 +2,8 @@
  ******************************************************************************
  * @file    simple_stateflow.c/h
  * @author  Enoky Bertram
- * @version V2.0.0
- * @date    Jun.4.2023
+ * @version V3.0.0
+ * @date    Oct.19.2026
  * @brief   A Simple State Flow Switcher /一个简易状态切换器
  * @note    happyhappyhappy
  ******************************************************************************
@@ -29,6 +29,45 @@
 
 #include "simple_stateflow.h"
 
+#include <string.h>
+
+#define STATEFLOW_NO_EVENT_SELECTED UINT8_MAX // 没有被选中的出口事件
+
+/**
+ * @brief 状态机 内部紧凑事件结构体，步进时访问
+ */
+typedef struct StateFlowCompactEvent
+{
+    bool (*guard)(stateflow_message_box_s_t *stateflow_msg); // 事件检测方法
+
+    stateflow_state_index_t toward_state; // 指向的状态
+
+    uint8_t priority; // 事件优先级
+} stateflow_compact_event_s_t;
+
+/**
+ * @brief 状态机 内部紧凑状态结构体，仅包含每个步进周期都会访问的数据
+ */
+typedef struct StateFlowCompactState
+{
+    void (*during)(stateflow_message_box_s_t *stateflow_msg); // 状态执行时方法
+
+    uint16_t first_exit_event;                  // 状态出口事件在出口事件池中的起始位置
+    uint8_t number_of_exit_events_that_instack; // 已设置的状态出口事件数量
+} stateflow_compact_state_s_t;
+
+/**
+ * @brief 状态机 内部紧凑数据结构体
+ * @note  进入时方法、退出时方法及重置标记仅在状态切换时访问，直接使用state_list中的数据
+ */
+struct StateFlowCompact
+{
+    stateflow_compact_event_s_t *exit_event_pool; // 系统所有状态的出口事件，各状态的出口事件连续存放
+    uint16_t number_of_exit_events_in_pool;       // 出口事件池中已分配的出口事件数量
+
+    stateflow_compact_state_s_t state_list[NUM_OF_STATE]; // 系统所有状态的紧凑数据
+};
+
 /**
  * @name    stateflow_execute
  * @brief   stateflow executing the current state
@@ -47,24 +86,48 @@ static void stateflow_execute(stateflow_s_t *stateflow);
 
 /**
  * @name    stateflow_guard
- * @brief   stateflow detect event triggering status
+ * @brief   stateflow detect event triggering status and determine the next state
  * @param   stateflow   stateflow structure pointer
- * @return  void
+ * @return  next state
  * @note    State internal call
  */
 /**
  * @name    stateflow_guard
- * @brief   状态机 检测事件触发状态
- * @param   stateflow   stateflow structure pointer
- * @return  void
+ * @brief   状态机 检测事件触发状态并确定下一状态
+ * @param   stateflow   状态机结构体地址
+ * @return  下一状态
  * @note    状态内部调用
  */
-static void stateflow_guard(stateflow_s_t *stateflow);
+static stateflow_state_index_t stateflow_guard(stateflow_s_t *stateflow);
+
+/**
+ * @name    stateflow_guard_select
+ * @brief   detect event triggering status of a state and select the exit event that determines the next state
+ * @param   stateflow       stateflow structure pointer
+ * @param   state           state whose exit events are detected
+ * @param   stateflow_msg   message box passed to the guards
+ * @param   is_triggered    set to true for every triggered exit event, NULL if not needed
+ * @return  index of the selected exit event within the state, STATEFLOW_NO_EVENT_SELECTED if none
+ * @note    State internal call
+ */
+/**
+ * @name    stateflow_guard_select
+ * @brief   检测指定状态的事件触发状态，选出决定下一状态的出口事件
+ * @param   stateflow       状态机结构体地址
+ * @param   state           被检测的状态
+ * @param   stateflow_msg   传给检测方法的状态机信箱
+ * @param   is_triggered    被触发的出口事件对应位置被置为true，不需要时为NULL
+ * @return  被选中的出口事件在该状态中的序号，没有被选中的出口事件时为STATEFLOW_NO_EVENT_SELECTED
+ * @note    状态内部调用
+ */
+static uint8_t stateflow_guard_select(stateflow_s_t *stateflow, stateflow_state_index_t state,
+                                      stateflow_message_box_s_t *stateflow_msg, bool *is_triggered);
 
 /**
  * @name    stateflow_switch
  * @brief   stateflow state switching
  * @param   stateflow   stateflow structure pointer
+ * @param   next_state  next state
  * @return  void
  * @note    State internal call
  */
@@ -72,10 +135,11 @@ static void stateflow_guard(stateflow_s_t *stateflow);
  * @name    stateflow_switch
  * @brief   状态机 状态切换
  * @param   stateflow   状态机结构体地址
+ * @param   next_state  下一个状态
  * @return  void
  * @note    状态内部调用
  */
-static void stateflow_switch(stateflow_s_t *stateflow);
+static void stateflow_switch(stateflow_s_t *stateflow, stateflow_state_index_t next_state);
 
 /**
  * @name    stateflow_state_entry_reset
@@ -93,7 +157,30 @@ static void stateflow_switch(stateflow_s_t *stateflow);
  * @return  void
  * @note    状态内部调用
  */
-static void stateflow_state_entry_reset(stateflow_s_t *stateflow, stateflow_state_table_e_t next_state);
+static void stateflow_state_entry_reset(stateflow_s_t *stateflow, stateflow_state_index_t next_state);
+
+/**
+ * @name    stateflow_explore_search
+ * @brief   mark all states reachable from the given state through selectable exit events
+ * @param   stateflow           stateflow structure pointer
+ * @param   from_state          state where the search starts
+ * @param   is_event_selectable whether each exit event in the exit event pool can be selected
+ * @param   visited             visit flags of all states
+ * @return  void
+ * @note    State internal call
+ */
+/**
+ * @name    stateflow_explore_search
+ * @brief   标记经由可能被选中的出口事件可从指定状态到达的所有状态
+ * @param   stateflow           状态机结构体地址
+ * @param   from_state          搜索起始状态
+ * @param   is_event_selectable 出口事件池中每个出口事件是否可能被选中
+ * @param   visited             所有状态的访问标记
+ * @return  void
+ * @note    状态内部调用
+ */
+static void stateflow_explore_search(stateflow_s_t *stateflow, stateflow_state_index_t from_state,
+                                     const bool *is_event_selectable, bool *visited);
 
 /**
  * @name    SSF_Init
@@ -126,8 +213,20 @@ stateflow_error SSF_Init(stateflow_s_t *stateflow, stateflow_state_table_e_t ini
         return stateflow->status = STATEFLOW_INIT_STATELIST_MALLOC_ERROR, stateflow->status;
     memset(stateflow->state_list, 0, NUM_OF_STATE * sizeof(stateflow_state_s_t));
 
+    // 为内部紧凑数据创建空间，出口事件池在创建状态时按需扩充
+    stateflow->compact = NULL;
+    stateflow->compact = (struct StateFlowCompact *)malloc(sizeof(struct StateFlowCompact));
+    if (stateflow->compact == NULL)
+    {
+        free(stateflow->state_list);
+        stateflow->state_list = NULL;
+        return stateflow->status = STATEFLOW_INIT_COMPACT_MALLOC_ERROR, stateflow->status;
+    }
+    memset(stateflow->compact, 0, sizeof(struct StateFlowCompact));
+
     // 设置系统初始状态
     stateflow->now_state = initial_state;
+    stateflow->initial_state = initial_state;
 
     // 初始化系统步进时钟
     stateflow->message_box.step_clock = 0;
@@ -136,7 +235,13 @@ stateflow_error SSF_Init(stateflow_s_t *stateflow, stateflow_state_table_e_t ini
     stateflow->message_box.uptime = NULL;
     stateflow->message_box.uptime = (uint32_t *)malloc(NUM_OF_STATE * sizeof(uint32_t));
     if (stateflow->message_box.uptime == NULL)
+    {
+        free(stateflow->compact);
+        stateflow->compact = NULL;
+        free(stateflow->state_list);
+        stateflow->state_list = NULL;
         return stateflow->status = STATEFLOW_INIT_UPTIME_MALLOC_ERROR, stateflow->status;
+    }
     memset(stateflow->message_box.uptime, 0, NUM_OF_STATE * sizeof(uint32_t));
 
     return stateflow->status = OK, stateflow->status;
@@ -184,6 +289,10 @@ stateflow_error SSF_CreateState(stateflow_s_t *stateflow, stateflow_state_table_
     if ((state_name == STATE_NULL) || (state_name == NUM_OF_STATE))
         return stateflow->status = STATE_CREATE_INPUT_ERROR, stateflow->status;
 
+    // 出口事件池容量检查
+    if (stateflow->compact->number_of_exit_events_in_pool + number_of_exit_events > UINT16_MAX)
+        return stateflow->status = STATE_CREATE_EVENT_POOL_FULL_ERROR, stateflow->status;
+
     /*设置状态底层数据*/
     // 状态名称
     stateflow->state_list[state_name].state_name = state_name;
@@ -192,18 +301,34 @@ stateflow_error SSF_CreateState(stateflow_s_t *stateflow, stateflow_state_table_
     stateflow->state_list[state_name].number_of_exit_events = number_of_exit_events;
     // 为状态的出口事件创建空间
     stateflow->state_list[state_name].exit_events = NULL;
-    stateflow->state_list[state_name].exit_events =
-        (stateflow_event_s_t *)malloc(number_of_exit_events * sizeof(stateflow_event_s_t));
-    if (stateflow->state_list[state_name].exit_events == NULL)
-        return stateflow->status = STATE_CREATE_MALLOC_ERROR, stateflow->status;
+    if (number_of_exit_events > 0)
+    {
+        stateflow->state_list[state_name].exit_events =
+            (stateflow_event_s_t *)malloc(number_of_exit_events * sizeof(stateflow_event_s_t));
+        if (stateflow->state_list[state_name].exit_events == NULL)
+            return stateflow->status = STATE_CREATE_MALLOC_ERROR, stateflow->status;
+
+        // 在内部出口事件池中为状态的出口事件扩充空间
+        stateflow_compact_event_s_t *exit_event_pool = (stateflow_compact_event_s_t *)realloc(
+            stateflow->compact->exit_event_pool,
+            (stateflow->compact->number_of_exit_events_in_pool + number_of_exit_events) *
+                sizeof(stateflow_compact_event_s_t));
+        if (exit_event_pool == NULL)
+            return stateflow->status = STATE_CREATE_MALLOC_ERROR, stateflow->status;
+        stateflow->compact->exit_event_pool = exit_event_pool;
+    }
+    stateflow->compact->state_list[state_name].first_exit_event = stateflow->compact->number_of_exit_events_in_pool;
+    stateflow->compact->number_of_exit_events_in_pool += number_of_exit_events;
     // 初始化已设置的状态出口事件数量
     stateflow->state_list[state_name].number_of_exit_events_that_instack = 0;
+    stateflow->compact->state_list[state_name].number_of_exit_events_that_instack = 0;
 
     // 设置状态进入时方法
     stateflow->state_list[state_name].entry = entry;
-    // 设置状态进入时方法
+    // 设置状态执行时方法
     stateflow->state_list[state_name].during = during;
-    // 设置状态进入时方法
+    stateflow->compact->state_list[state_name].during = during;
+    // 设置状态退出时方法
     stateflow->state_list[state_name].exit = exit;
 
     /*设置状态运行数据*/
@@ -240,6 +365,9 @@ stateflow_error SSF_StateAddExitEvent(stateflow_s_t *stateflow, stateflow_state_
                                       stateflow_state_table_e_t toward_state, uint8_t priority,
                                       bool (*guard)(stateflow_message_box_s_t *stateflow_msg))
 {
+    stateflow_event_s_t *exit_event;
+    stateflow_compact_event_s_t *compact_exit_event;
+
     // 状态机运行状态检查
     if (stateflow->status != OK)
         return stateflow->status;
@@ -254,28 +382,31 @@ stateflow_error SSF_StateAddExitEvent(stateflow_s_t *stateflow, stateflow_state_
         (toward_state == NUM_OF_STATE))
         return stateflow->status = EXIT_EVENT_ADD_INPUT_ERROR, stateflow->status;
 
-    // 触发状态初始化
-    stateflow->state_list[state_name]
-        .exit_events[stateflow->state_list[state_name].number_of_exit_events_that_instack]
-        .event_triggering_state = false;
+    // 定位此出口事件及其在内部出口事件池中的位置
+    exit_event =
+        &stateflow->state_list[state_name].exit_events[stateflow->state_list[state_name].number_of_exit_events_that_instack];
+    compact_exit_event =
+        &stateflow->compact->exit_event_pool[stateflow->compact->state_list[state_name].first_exit_event +
+                                             stateflow->state_list[state_name].number_of_exit_events_that_instack];
+
+    // 触发状态初始化，步进时不再写回触发状态，始终为false
+    exit_event->event_triggering_state = false;
 
     // 设置出口事件所指向的状态
-    stateflow->state_list[state_name]
-        .exit_events[stateflow->state_list[state_name].number_of_exit_events_that_instack]
-        .toward_state = toward_state;
+    exit_event->toward_state = toward_state;
+    compact_exit_event->toward_state = (stateflow_state_index_t)toward_state;
 
     // 设置出口事件优先级
-    stateflow->state_list[state_name]
-        .exit_events[stateflow->state_list[state_name].number_of_exit_events_that_instack]
-        .priority = priority;
+    exit_event->priority = priority;
+    compact_exit_event->priority = priority;
 
     // 设置出口事件检测方法
-    stateflow->state_list[state_name]
-        .exit_events[stateflow->state_list[state_name].number_of_exit_events_that_instack]
-        .guard = guard;
+    exit_event->guard = guard;
+    compact_exit_event->guard = guard;
 
     // 已设置的状态出口事件数量加一
     stateflow->state_list[state_name].number_of_exit_events_that_instack++;
+    stateflow->compact->state_list[state_name].number_of_exit_events_that_instack++;
 
     return stateflow->status = OK, stateflow->status;
 }
@@ -298,14 +429,16 @@ stateflow_error SSF_StateAddExitEvent(stateflow_s_t *stateflow, stateflow_state_
  */
 void SSF_Step(stateflow_s_t *stateflow)
 {
+    stateflow_state_index_t next_state;
+
     // 执行
     stateflow_execute(stateflow);
 
     // 检测
-    stateflow_guard(stateflow);
+    next_state = stateflow_guard(stateflow);
 
     // 切换
-    stateflow_switch(stateflow);
+    stateflow_switch(stateflow, next_state);
 
     // 系统步进时钟更新
     stateflow->message_box.step_clock++;
@@ -315,6 +448,191 @@ void SSF_Step(stateflow_s_t *stateflow)
     }
 }
 
+/**
+ * @name    SSF_Explore
+ * @brief   explore the state graph of stateflow and generate a report
+ * @param stateflow         stateflow structure pointer
+ * @param inputs            start address of representative message boxes, NULL for a static exploration that
+ *                          only uses the configuration of exit events
+ * @param number_of_inputs  the number of representative message boxes
+ * @param report            explore report structure pointer
+ * @return  stateflow_error
+ * @example SSF_Explore(&test_state_flow, test_inputs, 4, &test_report);
+ * @note    For every state and every representative message box, the guards of all exit events of the state
+ *          are called in step order on a copy of the message box and the next state is selected by the step
+ *          rule; reachability, cycles and shadowing are derived from the actual selection results. The
+ *          representative message boxes are the message box as seen by the guards: no state method is called
+ *          and the running data of stateflow is not changed. Guards are assumed to be pure, their result
+ *          depending only on the message box; guards depending on global data or on call counts make the
+ *          report inaccurate. An exit event that triggered but was never selected is reported as shadowed.
+ *          With inputs NULL no guard is called; an exit event that shares its guard with another one (so both
+ *          always trigger together, again assuming pure guards) and always loses to it is reported as shadowed,
+ *          and every other exit event is assumed selectable.
+ *          Self-loop exit events never switch state and form no cycle; a reachable state without any
+ *          selectable leaving exit event is a dead end.
+ */
+/**
+ * @name    SSF_Explore
+ * @brief   探索状态机的状态图并生成报告
+ * @param stateflow         状态机结构体地址
+ * @param inputs            有代表性的状态机信箱数组首地址，为NULL时仅依据出口事件的配置进行静态探索
+ * @param number_of_inputs  有代表性的状态机信箱数量
+ * @param report            探索报告结构体地址
+ * @return  stateflow_error
+ * @example SSF_Explore(&test_state_flow, test_inputs, 4, &test_report);
+ * @note    对每个状态及每个有代表性的信箱，在信箱副本上按步进时的顺序调用该状态所有出口事件的检测方法，
+ *          并按步进时的规则选出下一状态，可到达性、环路及遮蔽均由实际选择结果得出。
+ *          有代表性的信箱即检测时的信箱，不调用任何状态方法，不改变状态机运行数据。
+ *          检测方法被视为纯函数，其结果仅取决于信箱内容，依赖全局数据或调用次数的检测方法会使报告失真。
+ *          被触发过但从未被选中的出口事件判定为被遮蔽。
+ *          inputs为NULL时不调用检测方法，仅将检测方法相同(同样视为纯函数，总是同时触发)且总会输给另一事件的出口事件
+ *          判定为被遮蔽，其余出口事件均视为可能被选中。
+ *          指向自身的自环出口事件不会引起状态切换，不构成环路，没有可能被选中的离开事件的可到达状态视为死端。
+ */
+stateflow_error SSF_Explore(stateflow_s_t *stateflow, const stateflow_message_box_s_t *inputs,
+                            uint16_t number_of_inputs, stateflow_explore_report_s_t *report)
+{
+    bool visited[NUM_OF_STATE];
+    bool *is_event_selectable = NULL; // 每个出口事件是否可能被选中，按出口事件池中的位置存放
+
+    // 状态机运行状态检查
+    if (stateflow->status != OK)
+        return stateflow->status;
+
+    // 参数检查
+    if ((report == NULL) || ((inputs != NULL) && (number_of_inputs == 0)))
+        return STATEFLOW_EXPLORE_INPUT_ERROR;
+
+    memset(report, 0, sizeof(stateflow_explore_report_s_t));
+
+    if (stateflow->compact->number_of_exit_events_in_pool > 0)
+    {
+        is_event_selectable = (bool *)malloc(stateflow->compact->number_of_exit_events_in_pool * sizeof(bool));
+        if (is_event_selectable == NULL)
+            return STATEFLOW_EXPLORE_MALLOC_ERROR;
+        memset(is_event_selectable, 0, stateflow->compact->number_of_exit_events_in_pool * sizeof(bool));
+    }
+
+    /*确定每个出口事件是否可能被选中，统计被遮蔽的出口事件*/
+    for (uint16_t state = STATE_NULL + 1; state < NUM_OF_STATE; state++)
+    {
+        stateflow_compact_state_s_t *state_data = &stateflow->compact->state_list[state];
+        stateflow_compact_event_s_t *exit_events;
+        bool is_triggered[UINT8_MAX];
+        bool is_selected[UINT8_MAX];
+
+        if (state_data->number_of_exit_events_that_instack == 0)
+            continue;
+        exit_events = &stateflow->compact->exit_event_pool[state_data->first_exit_event];
+
+        memset(is_triggered, 0, sizeof(is_triggered));
+        memset(is_selected, 0, sizeof(is_selected));
+
+        if (inputs != NULL)
+        {
+            // 在每个有代表性的信箱副本上执行检测，记录被触发及被选中的出口事件
+            for (uint16_t k = 0; k < number_of_inputs; k++)
+            {
+                stateflow_message_box_s_t message_box = inputs[k];
+                uint8_t selected_event =
+                    stateflow_guard_select(stateflow, (stateflow_state_index_t)state, &message_box, is_triggered);
+
+                if (selected_event != STATEFLOW_NO_EVENT_SELECTED)
+                    is_selected[selected_event] = true;
+            }
+        }
+        else
+        {
+            // 检测方法相同时，两事件总是同时触发，优先级更高者(数值更小，同优先级时先添加者)总会被选中
+            // 触发的自环事件会使下一状态回到当前状态，其后触发的事件将不经优先级判定直接被选中，因此：
+            // 在前的自环事件不能遮蔽其后的事件；位于遮蔽事件与被遮蔽事件之间的自环事件会使遮蔽失效；
+            // 在后的优先级更高的自环事件会将已选中的事件重置，仍构成遮蔽
+            for (uint8_t i = 0; i < state_data->number_of_exit_events_that_instack; i++)
+            {
+                is_triggered[i] = true;
+                is_selected[i] = true;
+
+                for (uint8_t j = 0; j < state_data->number_of_exit_events_that_instack; j++)
+                {
+                    bool is_self_loop_between = false;
+                    for (uint8_t k = j + 1; k < i; k++)
+                    {
+                        if (exit_events[k].toward_state == state)
+                            is_self_loop_between = true;
+                    }
+
+                    if ((j != i) && ((exit_events[j].toward_state != state) || (j > i)) && !is_self_loop_between &&
+                        (exit_events[j].guard == exit_events[i].guard) &&
+                        ((exit_events[j].priority < exit_events[i].priority) ||
+                         ((exit_events[j].priority == exit_events[i].priority) && (j < i))))
+                    {
+                        is_selected[i] = false;
+                        break;
+                    }
+                }
+            }
+        }
+
+        for (uint8_t i = 0; i < state_data->number_of_exit_events_that_instack; i++)
+        {
+            is_event_selectable[state_data->first_exit_event + i] = is_selected[i];
+
+            // 被触发过但从未被选中的出口事件
+            if (is_triggered[i] && !is_selected[i])
+            {
+                report->number_of_shadowed_events[state]++;
+                report->number_of_shadowed_events_total++;
+            }
+        }
+    }
+
+    /*由初始状态出发，沿可能被选中的出口事件标记所有可到达的状态*/
+    memset(visited, 0, sizeof(visited));
+    visited[stateflow->initial_state] = true;
+    stateflow_explore_search(stateflow, (stateflow_state_index_t)stateflow->initial_state, is_event_selectable,
+                             visited);
+
+    for (uint16_t state = STATE_NULL + 1; state < NUM_OF_STATE; state++)
+    {
+        stateflow_compact_state_s_t *state_data = &stateflow->compact->state_list[state];
+        uint8_t number_of_leaving_events = 0;
+
+        // 不可到达状态
+        report->is_reachable[state] = visited[state];
+        if (!report->is_reachable[state])
+            report->number_of_unreachable_states++;
+
+        // 死端状态，未创建的状态及没有可能被选中的离开事件的状态均视为死端
+        for (uint8_t i = 0; i < state_data->number_of_exit_events_that_instack; i++)
+        {
+            if (is_event_selectable[state_data->first_exit_event + i] &&
+                (stateflow->compact->exit_event_pool[state_data->first_exit_event + i].toward_state != state))
+                number_of_leaving_events++;
+        }
+        if (report->is_reachable[state] && number_of_leaving_events == 0)
+        {
+            report->is_dead_end[state] = true;
+            report->number_of_dead_end_states++;
+        }
+    }
+
+    /*由每个状态出发，若能经由至少一次实际的状态切换回到其自身，则该状态位于环路上*/
+    // 自环事件不会引起状态切换，搜索时被忽略，仅有自环事件的状态不视为位于环路上
+    for (uint16_t state = STATE_NULL + 1; state < NUM_OF_STATE; state++)
+    {
+        memset(visited, 0, sizeof(visited));
+        stateflow_explore_search(stateflow, (stateflow_state_index_t)state, is_event_selectable, visited);
+
+        report->is_in_cycle[state] = visited[state];
+        if (report->is_in_cycle[state])
+            report->number_of_cycle_states++;
+    }
+
+    free(is_event_selectable);
+
+    return OK;
+}
+
 /**
  * @name    stateflow_execute
  * @brief   stateflow executing the current state
@@ -332,8 +650,8 @@ void SSF_Step(stateflow_s_t *stateflow)
 static void stateflow_execute(stateflow_s_t *stateflow)
 {
     // 执行状态执行时方法
-    if (stateflow->state_list[stateflow->now_state].during != NULL)
-        stateflow->state_list[stateflow->now_state].during(&stateflow->message_box);
+    if (stateflow->compact->state_list[stateflow->now_state].during != NULL)
+        stateflow->compact->state_list[stateflow->now_state].during(&stateflow->message_box);
 
     // 更新状态持续时间
     stateflow->message_box.uptime[stateflow->now_state]++;
@@ -341,73 +659,114 @@ static void stateflow_execute(stateflow_s_t *stateflow)
 
 /**
  * @name    stateflow_guard
- * @brief   stateflow detect event triggering status
+ * @brief   stateflow detect event triggering status and determine the next state
  * @param   stateflow   stateflow structure pointer
- * @return  void
+ * @return  next state
  * @note    State internal call
  */
 /**
  * @name    stateflow_guard
- * @brief   状态机 检测事件触发状态
- * @param   stateflow   stateflow structure pointer
- * @return  void
+ * @brief   状态机 检测事件触发状态并确定下一状态
+ * @param   stateflow   状态机结构体地址
+ * @return  下一状态
  * @note    状态内部调用
  */
-static void stateflow_guard(stateflow_s_t *stateflow)
+static stateflow_state_index_t stateflow_guard(stateflow_s_t *stateflow)
 {
-    // 更新所有已设置的出口事件的触发状态
-    for (uint8_t i = 0; i < stateflow->state_list[stateflow->now_state].number_of_exit_events_that_instack; i++)
-    {
-        stateflow->state_list[stateflow->now_state].exit_events[i].event_triggering_state =
-            stateflow->state_list[stateflow->now_state].exit_events[i].guard(&stateflow->message_box);
-    }
+    uint8_t selected_event = stateflow_guard_select(stateflow, (stateflow_state_index_t)stateflow->now_state,
+                                                    &stateflow->message_box, NULL);
+
+    if (selected_event == STATEFLOW_NO_EVENT_SELECTED)
+        return (stateflow_state_index_t)stateflow->now_state;
+
+    return stateflow->compact
+        ->exit_event_pool[stateflow->compact->state_list[stateflow->now_state].first_exit_event + selected_event]
+        .toward_state;
 }
 
 /**
- * @name    stateflow_switch
- * @brief   stateflow state switching
- * @param   stateflow   stateflow structure pointer
- * @return  void
+ * @name    stateflow_guard_select
+ * @brief   detect event triggering status of a state and select the exit event that determines the next state
+ * @param   stateflow       stateflow structure pointer
+ * @param   state           state whose exit events are detected
+ * @param   stateflow_msg   message box passed to the guards
+ * @param   is_triggered    set to true for every triggered exit event, NULL if not needed
+ * @return  index of the selected exit event within the state, STATEFLOW_NO_EVENT_SELECTED if none
  * @note    State internal call
  */
 /**
- * @name    stateflow_switch
- * @brief   状态机 状态切换
- * @param   stateflow   状态机结构体地址
- * @return  void
+ * @name    stateflow_guard_select
+ * @brief   检测指定状态的事件触发状态，选出决定下一状态的出口事件
+ * @param   stateflow       状态机结构体地址
+ * @param   state           被检测的状态
+ * @param   stateflow_msg   传给检测方法的状态机信箱
+ * @param   is_triggered    被触发的出口事件对应位置被置为true，不需要时为NULL
+ * @return  被选中的出口事件在该状态中的序号，没有被选中的出口事件时为STATEFLOW_NO_EVENT_SELECTED
  * @note    状态内部调用
  */
-static void stateflow_switch(stateflow_s_t *stateflow)
+static uint8_t stateflow_guard_select(stateflow_s_t *stateflow, stateflow_state_index_t state,
+                                      stateflow_message_box_s_t *stateflow_msg, bool *is_triggered)
 {
-    stateflow_state_table_e_t next_state = stateflow->now_state;
+    stateflow_compact_state_s_t *state_data = &stateflow->compact->state_list[state];
+    stateflow_compact_event_s_t *exit_events;
+    stateflow_state_index_t next_state = state;
     uint8_t temp_priority = 255;
+    uint8_t selected_event = STATEFLOW_NO_EVENT_SELECTED;
+
+    if (state_data->number_of_exit_events_that_instack == 0)
+        return STATEFLOW_NO_EVENT_SELECTED;
+    exit_events = &stateflow->compact->exit_event_pool[state_data->first_exit_event];
 
     /*检测所有已设置的出口事件的触发状态及优先级,确定下一状态*/
-    for (uint8_t i = 0; i < stateflow->state_list[stateflow->now_state].number_of_exit_events_that_instack; i++)
+    // 所有出口事件的检测方法都会被按序调用，触发状态不再写回事件结构体
+    for (uint8_t i = 0; i < state_data->number_of_exit_events_that_instack; i++)
     {
-        if (true == stateflow->state_list[stateflow->now_state].exit_events[i].event_triggering_state)
+        if (true == exit_events[i].guard(stateflow_msg))
         {
-            // 重置出口事件的触发状态
-            stateflow->state_list[stateflow->now_state].exit_events[i].event_triggering_state = false;
+            if (is_triggered != NULL)
+                is_triggered[i] = true;
 
             // 若仅有一个事件被触发，则将该事件的指向状态设为下一状态
             // 若多个事件被触发，则将所有触发的事件中最高优先级事件的指向状态设为下一状态
-            if (next_state == stateflow->now_state) // 第一个触发的事件，不进行优先级判定
+            if (next_state == state) // 第一个触发的事件，不进行优先级判定
             {
-                next_state = stateflow->state_list[stateflow->now_state].exit_events[i].toward_state;
-                temp_priority = stateflow->state_list[stateflow->now_state].exit_events[i].priority;
+                next_state = exit_events[i].toward_state;
+                temp_priority = exit_events[i].priority;
+                selected_event = i;
             }
-            else /*(next_state != stateflow->now_state)*/ // 后续触发的事件，进行优先级判定
+            else /*(next_state != state)*/ // 后续触发的事件，进行优先级判定
             {
-                if (stateflow->state_list[stateflow->now_state].exit_events[i].priority < temp_priority)
+                if (exit_events[i].priority < temp_priority)
                 {
-                    next_state = stateflow->state_list[stateflow->now_state].exit_events[i].toward_state;
-                    temp_priority = stateflow->state_list[stateflow->now_state].exit_events[i].priority;
+                    next_state = exit_events[i].toward_state;
+                    temp_priority = exit_events[i].priority;
+                    selected_event = i;
                 }
             }
         }
     }
 
+    return selected_event;
+}
+
+/**
+ * @name    stateflow_switch
+ * @brief   stateflow state switching
+ * @param   stateflow   stateflow structure pointer
+ * @param   next_state  next state
+ * @return  void
+ * @note    State internal call
+ */
+/**
+ * @name    stateflow_switch
+ * @brief   状态机 状态切换
+ * @param   stateflow   状态机结构体地址
+ * @param   next_state  下一个状态
+ * @return  void
+ * @note    状态内部调用
+ */
+static void stateflow_switch(stateflow_s_t *stateflow, stateflow_state_index_t next_state)
+{
     /*状态切换*/
     if (next_state != stateflow->now_state)
     {
@@ -418,7 +777,7 @@ static void stateflow_switch(stateflow_s_t *stateflow)
         //  更新系统状态记录
         stateflow->last_state = stateflow->now_state;
         // 更新系统当前状态为已触发的出口事件所指向的状态
-        stateflow->now_state = next_state;
+        stateflow->now_state = (stateflow_state_table_e_t)next_state;
 
         // 重置下一状态运行数据
         stateflow_state_entry_reset(stateflow, next_state);
@@ -444,7 +803,7 @@ static void stateflow_switch(stateflow_s_t *stateflow)
  * @return  void
  * @note    状态内部调用
  */
-static void stateflow_state_entry_reset(stateflow_s_t *stateflow, stateflow_state_table_e_t next_state)
+static void stateflow_state_entry_reset(stateflow_s_t *stateflow, stateflow_state_index_t next_state)
 {
     if (stateflow->state_list[next_state].is_need_to_reset)
     {
@@ -453,3 +812,55 @@ static void stateflow_state_entry_reset(stateflow_s_t *stateflow, stateflow_stat
         // stateflow->state_list[next_state].uptime = 0;            // 状态持续时间
     }
 }
+
+/**
+ * @name    stateflow_explore_search
+ * @brief   mark all states reachable from the given state through selectable exit events
+ * @param   stateflow           stateflow structure pointer
+ * @param   from_state          state where the search starts
+ * @param   is_event_selectable whether each exit event in the exit event pool can be selected
+ * @param   visited             visit flags of all states
+ * @return  void
+ * @note    State internal call
+ */
+/**
+ * @name    stateflow_explore_search
+ * @brief   标记经由可能被选中的出口事件可从指定状态到达的所有状态
+ * @param   stateflow           状态机结构体地址
+ * @param   from_state          搜索起始状态
+ * @param   is_event_selectable 出口事件池中每个出口事件是否可能被选中
+ * @param   visited             所有状态的访问标记
+ * @return  void
+ * @note    状态内部调用
+ */
+static void stateflow_explore_search(stateflow_s_t *stateflow, stateflow_state_index_t from_state,
+                                     const bool *is_event_selectable, bool *visited)
+{
+    // 广度优先搜索队列，除起始状态外每个状态至多入队一次，且STATE_NULL不会被出口事件指向
+    stateflow_state_index_t queue[NUM_OF_STATE];
+    uint16_t queue_head = 0;
+    uint16_t queue_tail = 0;
+
+    queue[queue_tail++] = from_state;
+
+    while (queue_head < queue_tail)
+    {
+        stateflow_compact_state_s_t *state_data = &stateflow->compact->state_list[queue[queue_head++]];
+
+        for (uint8_t i = 0; i < state_data->number_of_exit_events_that_instack; i++)
+        {
+            stateflow_state_index_t toward_state =
+                stateflow->compact->exit_event_pool[state_data->first_exit_event + i].toward_state;
+
+            // 永远不会被选中的出口事件及不会引起状态切换的自环事件，忽略
+            if (!is_event_selectable[state_data->first_exit_event + i] || (toward_state == queue[queue_head - 1]))
+                continue;
+
+            if (!visited[toward_state])
+            {
+                visited[toward_state] = true;
+                queue[queue_tail++] = toward_state;
+            }
+        }
+    }
+}
@@ -2,8 +2,8 @@
  ******************************************************************************
  * @file    simple_stateflow.c/h
  * @author  Enoky Bertram form Earth
- * @version V2.0.0
- * @date    Jun.4.2023
+ * @version V3.0.0
+ * @date    Oct.19.2026
  * @brief   A Simple State Flow Switcher /一个简易状态切换器
  * @note    happyhappyhappy
  ******************************************************************************
@@ -57,6 +57,21 @@ typedef struct StateFlowDataBox
 
 #define CLOCK_MAX_LIMIT 4294967290 // 步进时钟上限
 
+/*状态数量(含STATE_NULL)超过256时，在下面这里打开此宏，使用16位状态索引*/
+
+// #define SSF_STATE_INDEX_16BIT
+
+/*状态数量(含STATE_NULL)超过256时，在上面这里打开此宏，使用16位状态索引*/
+
+#ifdef SSF_STATE_INDEX_16BIT
+typedef uint16_t stateflow_state_index_t; // 状态机内部紧凑数据中的状态索引
+#else
+typedef uint8_t stateflow_state_index_t; // 状态机内部紧凑数据中的状态索引
+#endif
+
+// 状态索引位宽检查，状态数量超出索引范围时在此处编译报错
+typedef char stateflow_state_index_check_t[(NUM_OF_STATE <= ((stateflow_state_index_t)-1) + 1) ? 1 : -1];
+
 /**
  * @brief 状态机 事件结构体
  */
@@ -109,6 +124,14 @@ typedef enum StateFlowError
     STATE_CREATE_MALLOC_ERROR,
     EXIT_EVENT_ADD_INPUT_ERROR,
     EXIT_EVENT_ADD_NUM_ERROR,
+    STATEFLOW_EXPLORE_INPUT_ERROR,
+    STATEFLOW_SIMULATE_INPUT_ERROR,
+    STATEFLOW_SIMULATE_OUTPUT_FULL_ERROR,
+    STATE_CREATE_EVENT_POOL_FULL_ERROR,
+    STATEFLOW_EXPLORE_MALLOC_ERROR,
+    STATEFLOW_SIMULATE_LOG_FORMAT_ERROR,
+    STATEFLOW_SIMULATE_FILE_ERROR,
+    STATEFLOW_INIT_COMPACT_MALLOC_ERROR,
 } stateflow_error;
 
 /**
@@ -118,14 +141,34 @@ typedef struct StateFlow
 {
     stateflow_error status; // 状态机运行状态
 
-    stateflow_state_s_t *state_list;     // 系统所有状态
+    stateflow_state_s_t *state_list;     // 系统所有状态，其中执行时方法及出口事件在设置后修改不影响运行
     stateflow_state_table_e_t now_state; // 系统当前状态
 
     stateflow_state_table_e_t last_state; // 上一个状态，状态退出时更新
 
+    stateflow_state_table_e_t initial_state; // 系统初始状态，状态图探索的起点
+
+    struct StateFlowCompact *compact; // 状态机内部紧凑数据，步进时使用，布局不对外公开
+
     stateflow_message_box_s_t message_box;
 } stateflow_s_t;
 
+/**
+ * @brief 状态机 状态图探索报告结构体
+ */
+typedef struct StateFlowExploreReport
+{
+    bool is_reachable[NUM_OF_STATE];                 // 此状态可由初始状态到达
+    bool is_dead_end[NUM_OF_STATE];                  // 此状态可到达但没有可能被选中的离开此状态的出口事件
+    bool is_in_cycle[NUM_OF_STATE];                  // 此状态位于状态图的环路上，自环不计
+    uint8_t number_of_shadowed_events[NUM_OF_STATE]; // 此状态中被遮蔽、永远不会被选中的出口事件数量
+
+    uint16_t number_of_unreachable_states;    // 不可到达的状态总数
+    uint16_t number_of_dead_end_states;       // 死端状态总数
+    uint16_t number_of_cycle_states;          // 位于环路上的状态总数
+    uint16_t number_of_shadowed_events_total; // 被遮蔽的出口事件总数
+} stateflow_explore_report_s_t;
+
 /**
  * @name    SSF_Init
  * @brief   状态机初始化
@@ -183,4 +226,25 @@ stateflow_error SSF_StateAddExitEvent(stateflow_s_t *stateflow, stateflow_state_
  */
 void SSF_Step(stateflow_s_t *stateflow);
 
+/**
+ * @name    SSF_Explore
+ * @brief   探索状态机的状态图并生成报告
+ * @param stateflow         状态机结构体地址
+ * @param inputs            有代表性的状态机信箱数组首地址，为NULL时仅依据出口事件的配置进行静态探索
+ * @param number_of_inputs  有代表性的状态机信箱数量
+ * @param report            探索报告结构体地址
+ * @return  stateflow_error
+ * @example SSF_Explore(&test_state_flow, test_inputs, 4, &test_report);
+ * @note    对每个状态及每个有代表性的信箱，在信箱副本上按步进时的顺序调用该状态所有出口事件的检测方法，
+ *          并按步进时的规则选出下一状态，可到达性、环路及遮蔽均由实际选择结果得出。
+ *          有代表性的信箱即检测时的信箱，不调用任何状态方法，不改变状态机运行数据。
+ *          检测方法被视为纯函数，其结果仅取决于信箱内容，依赖全局数据或调用次数的检测方法会使报告失真。
+ *          被触发过但从未被选中的出口事件判定为被遮蔽。
+ *          inputs为NULL时不调用检测方法，仅将检测方法相同(同样视为纯函数，总是同时触发)且总会输给另一事件的出口事件
+ *          判定为被遮蔽，其余出口事件均视为可能被选中。
+ *          指向自身的自环出口事件不会引起状态切换，不构成环路，没有可能被选中的离开事件的可到达状态视为死端。
+ */
+stateflow_error SSF_Explore(stateflow_s_t *stateflow, const stateflow_message_box_s_t *inputs,
+                            uint16_t number_of_inputs, stateflow_explore_report_s_t *report);
+
 #endif /* __STATEFLOW_H_ */
@@ -0,0 +1,658 @@
+/**
+ ******************************************************************************
+ * @file    simple_stateflow_simulate.c/h
+ * @author  Enoky Bertram
+ * @version V2.2.0
+ * @date    Oct.19.2026
+ * @brief   Offline Simulation of Simple State Flow /简易状态切换器离线仿真
+ * @note    happyhappyhappy
+ ******************************************************************************
+ * @example
+ * Please see demo. c
+ * 请见demo.c
+ *
+ * @attention
+ * 1. Input logs are stored by column, one column per message box field. The column data is copied into the
+ *    message box fields described by the field table before every step, no parsing is done during simulation.
+ *    输入记录按列存储，每个信箱字段一列。每个步进周期前按字段描述表将各列数据拷入信箱字段，仿真过程中不做任何解析。
+ *
+ * 2. Input log files are memory-mapped, the columns point directly into the mapping.
+ *    输入记录文件以内存映射方式打开，各列直接指向映射的文件内容。
+ ******************************************************************************
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "simple_stateflow_simulate.h"
+
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define SSF_SIMULATE_LOG_HEADER_SIZE 16 // 输入记录文件头字节数，不含各列数据字节数
+
+/**
+ * @brief 状态机 批量离线仿真线程参数结构体
+ */
+typedef struct StateFlowSimulateWorker
+{
+    stateflow_simulate_job_s_t *jobs;           // 仿真任务数组首地址
+    uint16_t number_of_jobs;                    // 仿真任务数量
+    const stateflow_simulate_field_s_t *fields; // 信箱字段描述
+    uint16_t number_of_fields;                  // 信箱字段描述数量
+    uint8_t worker_index;                       // 线程序号，执行序号为worker_index + k * number_of_workers的任务
+    uint8_t number_of_workers;                  // 线程数
+} stateflow_simulate_worker_s_t;
+
+/**
+ * @name    stateflow_simulate_align
+ * @brief   round a byte count up to the column alignment of input log files
+ * @param   size    byte count
+ * @return  aligned byte count
+ * @note    Simulate internal call
+ */
+/**
+ * @name    stateflow_simulate_align
+ * @brief   将字节数向上对齐到输入记录文件的列对齐字节数
+ * @param   size    字节数
+ * @return  对齐后的字节数
+ * @note    仿真内部调用
+ */
+static uint64_t stateflow_simulate_align(uint64_t size);
+
+/**
+ * @name    stateflow_simulate_worker
+ * @brief   run the simulation jobs assigned to one worker
+ * @param   worker  worker parameter structure pointer
+ * @return  void
+ * @note    Simulate internal call
+ */
+/**
+ * @name    stateflow_simulate_worker
+ * @brief   执行分配给一个线程的仿真任务
+ * @param   worker  线程参数结构体地址
+ * @return  void
+ * @note    仿真内部调用
+ */
+static void stateflow_simulate_worker(stateflow_simulate_worker_s_t *worker);
+
+/**
+ * @name    stateflow_simulate_thread
+ * @brief   thread entry of a batch simulation worker
+ * @param   worker  worker parameter structure pointer
+ * @return  0 / NULL
+ * @note    Simulate internal call
+ */
+/**
+ * @name    stateflow_simulate_thread
+ * @brief   批量仿真线程入口
+ * @param   worker  线程参数结构体地址
+ * @return  0 / NULL
+ * @note    仿真内部调用
+ */
+#ifdef _WIN32
+static DWORD WINAPI stateflow_simulate_thread(LPVOID worker);
+#else
+static void *stateflow_simulate_thread(void *worker);
+#endif
+
+/**
+ * @name    SSF_SimulateLogOpen
+ * @brief   open an input log from input log file content in memory
+ * @param log   input log structure pointer
+ * @param data  start address of input log file content
+ * @param size  the number of bytes of input log file content
+ * @return  stateflow_error
+ * @example SSF_SimulateLogOpen(&test_log, log_data, log_size);
+ * @note    The columns point directly into data without any copy, data must stay valid while the log is used.
+ */
+/**
+ * @name    SSF_SimulateLogOpen
+ * @brief   由内存中的输入记录文件内容打开输入记录
+ * @param log   输入记录结构体地址
+ * @param data  输入记录文件内容首地址
+ * @param size  输入记录文件内容字节数
+ * @return  stateflow_error
+ * @example SSF_SimulateLogOpen(&test_log, log_data, log_size);
+ * @note    各列直接指向data内的数据，不做任何拷贝，data在输入记录使用期间须保持有效。
+ */
+stateflow_error SSF_SimulateLogOpen(stateflow_simulate_log_s_t *log, const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint32_t magic;
+    uint64_t column_offset;
+
+    // 参数检查
+    if ((log == NULL) || (data == NULL))
+        return STATEFLOW_SIMULATE_INPUT_ERROR;
+
+    memset(log->columns, 0, sizeof(log->columns));
+    memset(log->column_size, 0, sizeof(log->column_size));
+    log->number_of_columns = 0;
+    log->number_of_ticks = 0;
+
+    /*解析文件头*/
+    if (size < SSF_SIMULATE_LOG_HEADER_SIZE)
+        return STATEFLOW_SIMULATE_LOG_FORMAT_ERROR;
+    memcpy(&magic, bytes, sizeof(magic));
+    memcpy(&log->number_of_columns, bytes + 4, sizeof(log->number_of_columns));
+    memcpy(&log->number_of_ticks, bytes + 8, sizeof(log->number_of_ticks));
+    if ((magic != SSF_SIMULATE_LOG_MAGIC) || (log->number_of_columns > SSF_SIMULATE_MAX_COLUMNS))
+        return STATEFLOW_SIMULATE_LOG_FORMAT_ERROR;
+
+    // 各列单个数据的字节数
+    column_offset = SSF_SIMULATE_LOG_HEADER_SIZE + (uint64_t)log->number_of_columns * sizeof(uint16_t);
+    if (column_offset > size)
+        return STATEFLOW_SIMULATE_LOG_FORMAT_ERROR;
+    memcpy(log->column_size, bytes + SSF_SIMULATE_LOG_HEADER_SIZE, log->number_of_columns * sizeof(uint16_t));
+
+    /*定位各列，各列直接指向文件内容*/
+    for (uint16_t k = 0; k < log->number_of_columns; k++)
+    {
+        column_offset = stateflow_simulate_align(column_offset);
+        if (column_offset + (uint64_t)log->column_size[k] * log->number_of_ticks > size)
+            return STATEFLOW_SIMULATE_LOG_FORMAT_ERROR;
+
+        log->columns[k] = bytes + column_offset;
+        column_offset += (uint64_t)log->column_size[k] * log->number_of_ticks;
+    }
+
+    return OK;
+}
+
+/**
+ * @name    SSF_SimulateLogMap
+ * @brief   map an input log file into memory and open the input log
+ * @param log   input log structure pointer
+ * @param path  path of input log file
+ * @return  stateflow_error
+ * @example SSF_SimulateLogMap(&test_log, "test_log.ssf");
+ * @note    SSF_SimulateLogUnmap must be called after use.
+ */
+/**
+ * @name    SSF_SimulateLogMap
+ * @brief   将输入记录文件映射到内存并打开输入记录
+ * @param log   输入记录结构体地址
+ * @param path  输入记录文件路径
+ * @return  stateflow_error
+ * @example SSF_SimulateLogMap(&test_log, "test_log.ssf");
+ * @note    使用完毕后须调用SSF_SimulateLogUnmap。
+ */
+stateflow_error SSF_SimulateLogMap(stateflow_simulate_log_s_t *log, const char *path)
+{
+    stateflow_error status;
+
+    // 参数检查
+    if ((log == NULL) || (path == NULL))
+        return STATEFLOW_SIMULATE_INPUT_ERROR;
+
+    log->map_address = NULL;
+    log->map_size = 0;
+
+    /*映射文件*/
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    LARGE_INTEGER file_size;
+    HANDLE mapping;
+
+    if (file == INVALID_HANDLE_VALUE)
+        return STATEFLOW_SIMULATE_FILE_ERROR;
+    if (!GetFileSizeEx(file, &file_size) || (file_size.QuadPart == 0))
+    {
+        CloseHandle(file);
+        return STATEFLOW_SIMULATE_FILE_ERROR;
+    }
+
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (mapping == NULL)
+        return STATEFLOW_SIMULATE_FILE_ERROR;
+
+    // 映射视图会保持文件映射对象有效
+    log->map_address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (log->map_address == NULL)
+        return STATEFLOW_SIMULATE_FILE_ERROR;
+    log->map_size = (size_t)file_size.QuadPart;
+#else
+    int file = open(path, O_RDONLY);
+    struct stat file_status;
+    void *map_address;
+
+    if (file < 0)
+        return STATEFLOW_SIMULATE_FILE_ERROR;
+    if ((fstat(file, &file_status) != 0) || (file_status.st_size == 0))
+    {
+        close(file);
+        return STATEFLOW_SIMULATE_FILE_ERROR;
+    }
+
+    // 映射会保持文件内容有效
+    map_address = mmap(NULL, (size_t)file_status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (map_address == MAP_FAILED)
+        return STATEFLOW_SIMULATE_FILE_ERROR;
+    log->map_address = map_address;
+    log->map_size = (size_t)file_status.st_size;
+#endif
+
+    /*解析映射的文件内容*/
+    status = SSF_SimulateLogOpen(log, log->map_address, log->map_size);
+    if (status != OK)
+        SSF_SimulateLogUnmap(log);
+
+    return status;
+}
+
+/**
+ * @name    SSF_SimulateLogUnmap
+ * @brief   unmap an input log file from memory
+ * @param log   input log structure pointer
+ * @return  void
+ * @example SSF_SimulateLogUnmap(&test_log);
+ * @note    none
+ */
+/**
+ * @name    SSF_SimulateLogUnmap
+ * @brief   解除输入记录文件的内存映射
+ * @param log   输入记录结构体地址
+ * @return  void
+ * @example SSF_SimulateLogUnmap(&test_log);
+ * @note    无
+ */
+void SSF_SimulateLogUnmap(stateflow_simulate_log_s_t *log)
+{
+    if ((log == NULL) || (log->map_address == NULL))
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(log->map_address);
+#else
+    munmap((void *)log->map_address, log->map_size);
+#endif
+
+    log->map_address = NULL;
+    log->map_size = 0;
+    log->number_of_columns = 0;
+    log->number_of_ticks = 0;
+}
+
+/**
+ * @name    SSF_SimulateLogWrite
+ * @brief   write data stored by column as an input log file
+ * @param file              file opened in binary write mode
+ * @param columns           start addresses of all columns
+ * @param column_size       the number of bytes per data of all columns
+ * @param number_of_columns the number of columns
+ * @param number_of_ticks   the number of step cycles
+ * @return  stateflow_error
+ * @example SSF_SimulateLogWrite(log_file, test_columns, test_column_size, 1, 10);
+ * @note    For data recording programs to generate input log files.
+ */
+/**
+ * @name    SSF_SimulateLogWrite
+ * @brief   将按列存放的数据写为输入记录文件
+ * @param file              以二进制写方式打开的文件
+ * @param columns           各列数据首地址
+ * @param column_size       各列单个数据的字节数
+ * @param number_of_columns 列数
+ * @param number_of_ticks   步进周期数
+ * @return  stateflow_error
+ * @example SSF_SimulateLogWrite(log_file, test_columns, test_column_size, 1, 10);
+ * @note    供数据录制程序生成输入记录文件。
+ */
+stateflow_error SSF_SimulateLogWrite(FILE *file, const void *const *columns, const uint16_t *column_size,
+                                     uint16_t number_of_columns, uint32_t number_of_ticks)
+{
+    const uint8_t padding[SSF_SIMULATE_LOG_ALIGN] = {0};
+    uint8_t header[SSF_SIMULATE_LOG_HEADER_SIZE] = {0};
+    uint32_t magic = SSF_SIMULATE_LOG_MAGIC;
+    uint64_t offset;
+
+    // 参数检查
+    if ((file == NULL) || (columns == NULL) || (column_size == NULL) ||
+        (number_of_columns > SSF_SIMULATE_MAX_COLUMNS))
+        return STATEFLOW_SIMULATE_INPUT_ERROR;
+
+    /*写入文件头*/
+    memcpy(header, &magic, sizeof(magic));
+    memcpy(header + 4, &number_of_columns, sizeof(number_of_columns));
+    memcpy(header + 8, &number_of_ticks, sizeof(number_of_ticks));
+    if ((fwrite(header, sizeof(header), 1, file) != 1) ||
+        (fwrite(column_size, sizeof(uint16_t), number_of_columns, file) != number_of_columns))
+        return STATEFLOW_SIMULATE_FILE_ERROR;
+    offset = SSF_SIMULATE_LOG_HEADER_SIZE + (uint64_t)number_of_columns * sizeof(uint16_t);
+
+    /*依次写入各列，每列起始按8字节对齐*/
+    for (uint16_t k = 0; k < number_of_columns; k++)
+    {
+        size_t padding_size = (size_t)(stateflow_simulate_align(offset) - offset);
+
+        if ((padding_size > 0) && (fwrite(padding, 1, padding_size, file) != padding_size))
+            return STATEFLOW_SIMULATE_FILE_ERROR;
+        if ((number_of_ticks > 0) && (fwrite(columns[k], column_size[k], number_of_ticks, file) != number_of_ticks))
+            return STATEFLOW_SIMULATE_FILE_ERROR;
+
+        offset += padding_size + (uint64_t)column_size[k] * number_of_ticks;
+    }
+
+    return OK;
+}
+
+/**
+ * @name    SSF_Simulate
+ * @brief   simulate stateflow offline with an input log
+ * @param stateflow                 stateflow structure pointer
+ * @param log                       input log
+ * @param fields                    message box field descriptions of the log columns, the k-th for the k-th column
+ * @param number_of_fields          the number of field descriptions, not more than the number of log columns
+ * @param first_tick                index of the first step cycle
+ * @param output                    start address of the transition record output buffer
+ * @param output_size               the number of records the output buffer can hold
+ * @param number_of_records         the number of transition records written
+ * @param number_of_ticks_processed the number of step cycles executed
+ * @return  stateflow_error
+ * @example SSF_Simulate(&test_state_flow, &test_log, test_fields, 1, 0, test_records, 1024, &test_record_count,
+ *                       &test_tick_count);
+ * @note    Before every step the column data is copied into the message box fields, no real-time pacing is
+ *          done. When the output buffer is full and step cycles remain, the simulation stops and returns
+ *          STATEFLOW_SIMULATE_OUTPUT_FULL_ERROR; every switch in the executed step cycles has been recorded,
+ *          continue from first_tick + number_of_ticks_processed.
+ */
+/**
+ * @name    SSF_Simulate
+ * @brief   以输入记录离线仿真状态机
+ * @param stateflow                 状态机结构体地址
+ * @param log                       输入记录
+ * @param fields                    输入记录各列对应的信箱字段描述，第k个描述对应第k列
+ * @param number_of_fields          信箱字段描述数量，不大于输入记录列数
+ * @param first_tick                起始步进周期序号
+ * @param output                    状态切换记录输出缓冲区首地址
+ * @param output_size               状态切换记录输出缓冲区可容纳的记录数
+ * @param number_of_records         已写入的状态切换记录数
+ * @param number_of_ticks_processed 已执行的步进周期数
+ * @return  stateflow_error
+ * @example SSF_Simulate(&test_state_flow, &test_log, test_fields, 1, 0, test_records, 1024, &test_record_count,
+ *                       &test_tick_count);
+ * @note    每个步进周期先将各列数据拷入对应的信箱字段，再执行一个步进周期，不做任何实时节拍控制。
+ *          输出缓冲区写满且仍有未执行的步进周期时，仿真停止并返回STATEFLOW_SIMULATE_OUTPUT_FULL_ERROR，
+ *          此时已执行的步进周期中的所有切换均已被记录，以first_tick + number_of_ticks_processed为起始序号继续仿真即可。
+ */
+stateflow_error SSF_Simulate(stateflow_s_t *stateflow, const stateflow_simulate_log_s_t *log,
+                             const stateflow_simulate_field_s_t *fields, uint16_t number_of_fields,
+                             uint32_t first_tick, stateflow_transition_record_s_t *output, uint32_t output_size,
+                             uint32_t *number_of_records, uint32_t *number_of_ticks_processed)
+{
+    uint8_t *message_box = (uint8_t *)&stateflow->message_box;
+    stateflow_state_table_e_t state_before_step;
+
+    // 状态机运行状态检查
+    if (stateflow->status != OK)
+        return stateflow->status;
+
+    // 参数检查
+    if ((log == NULL) || ((fields == NULL) && (number_of_fields > 0)) || (output == NULL) || (output_size == 0) ||
+        (number_of_records == NULL) || (number_of_ticks_processed == NULL) ||
+        (number_of_fields > log->number_of_columns) || (first_tick > log->number_of_ticks))
+        return STATEFLOW_SIMULATE_INPUT_ERROR;
+
+    // 字段描述检查，每个字段须位于信箱内且与对应列的数据字节数一致
+    for (uint16_t k = 0; k < number_of_fields; k++)
+    {
+        if ((fields[k].size != log->column_size[k]) ||
+            ((uint32_t)fields[k].offset + fields[k].size > sizeof(stateflow_message_box_s_t)))
+            return STATEFLOW_SIMULATE_INPUT_ERROR;
+    }
+
+    *number_of_records = 0;
+    *number_of_ticks_processed = 0;
+
+    for (uint32_t tick = first_tick; tick < log->number_of_ticks; tick++)
+    {
+        // 将本步进周期的各列数据拷入信箱字段
+        for (uint16_t k = 0; k < number_of_fields; k++)
+        {
+            memcpy(message_box + fields[k].offset, (const uint8_t *)log->columns[k] + (size_t)tick * fields[k].size,
+                   fields[k].size);
+        }
+
+        // 执行一个步进周期
+        state_before_step = stateflow->now_state;
+        SSF_Step(stateflow);
+        (*number_of_ticks_processed)++;
+
+        // 记录状态切换
+        if (stateflow->now_state != state_before_step)
+        {
+            output[*number_of_records].tick = tick;
+            output[*number_of_records].from_state = (uint16_t)state_before_step;
+            output[*number_of_records].to_state = (uint16_t)stateflow->now_state;
+            (*number_of_records)++;
+
+            // 输出缓冲区已满且仍有未执行的步进周期，停止仿真，已执行的切换均已被记录
+            if ((*number_of_records == output_size) && (tick + 1 < log->number_of_ticks))
+                return STATEFLOW_SIMULATE_OUTPUT_FULL_ERROR;
+        }
+    }
+
+    return OK;
+}
+
+/**
+ * @name    SSF_SimulateBatch
+ * @brief   simulate multiple stateflows offline in batch with multiple threads
+ * @param jobs              start address of the simulation job array
+ * @param number_of_jobs    the number of simulation jobs
+ * @param fields            message box field descriptions of the log columns, shared by all jobs
+ * @param number_of_fields  the number of field descriptions
+ * @param number_of_threads the number of threads, the jobs run one by one in the calling thread for 0 or 1
+ * @return  stateflow_error result of the first failed job, OK if all jobs succeed
+ * @example SSF_SimulateBatch(test_jobs, 2, test_fields, 1, 2);
+ * @note    The stateflows of all jobs must be different from each other. Guards and state methods are called in
+ *          multiple threads at the same time and must not use unprotected global data. If a thread cannot be
+ *          created, its jobs run in the calling thread instead.
+ */
+/**
+ * @name    SSF_SimulateBatch
+ * @brief   多线程批量离线仿真多个状态机
+ * @param jobs              仿真任务数组首地址
+ * @param number_of_jobs    仿真任务数量
+ * @param fields            输入记录各列对应的信箱字段描述，所有任务共用
+ * @param number_of_fields  信箱字段描述数量
+ * @param number_of_threads 线程数，为0或1时在调用线程中依次执行
+ * @return  stateflow_error 第一个失败任务的仿真结果，全部成功时为OK
+ * @example SSF_SimulateBatch(test_jobs, 2, test_fields, 1, 2);
+ * @note    各任务的状态机须互不相同，检测方法及状态方法会在多个线程中同时被调用，不可使用无保护的全局数据。
+ *          线程创建失败时，该线程的任务改在调用线程中执行。
+ */
+stateflow_error SSF_SimulateBatch(stateflow_simulate_job_s_t *jobs, uint16_t number_of_jobs,
+                                  const stateflow_simulate_field_s_t *fields, uint16_t number_of_fields,
+                                  uint8_t number_of_threads)
+{
+    stateflow_simulate_worker_s_t workers[SSF_SIMULATE_MAX_THREADS];
+#ifdef _WIN32
+    HANDLE threads[SSF_SIMULATE_MAX_THREADS];
+#else
+    pthread_t threads[SSF_SIMULATE_MAX_THREADS];
+#endif
+    bool is_thread_created[SSF_SIMULATE_MAX_THREADS];
+    uint8_t number_of_workers;
+
+    // 参数检查
+    if ((jobs == NULL) && (number_of_jobs > 0))
+        return STATEFLOW_SIMULATE_INPUT_ERROR;
+
+    // 线程数不超过任务数及最大线程数
+    number_of_workers = (number_of_threads == 0) ? 1 : number_of_threads;
+    if (number_of_workers > SSF_SIMULATE_MAX_THREADS)
+        number_of_workers = SSF_SIMULATE_MAX_THREADS;
+    if (number_of_workers > number_of_jobs)
+        number_of_workers = (number_of_jobs == 0) ? 1 : (uint8_t)number_of_jobs;
+
+    /*按序号交错分配任务，第0份在调用线程中执行，其余各份各启动一个线程*/
+    for (uint8_t w = 0; w < number_of_workers; w++)
+    {
+        workers[w].jobs = jobs;
+        workers[w].number_of_jobs = number_of_jobs;
+        workers[w].fields = fields;
+        workers[w].number_of_fields = number_of_fields;
+        workers[w].worker_index = w;
+        workers[w].number_of_workers = number_of_workers;
+        is_thread_created[w] = false;
+
+        if (w == 0)
+            continue;
+#ifdef _WIN32
+        threads[w] = CreateThread(NULL, 0, stateflow_simulate_thread, &workers[w], 0, NULL);
+        is_thread_created[w] = (threads[w] != NULL);
+#else
+        is_thread_created[w] = (pthread_create(&threads[w], NULL, stateflow_simulate_thread, &workers[w]) == 0);
+#endif
+    }
+
+    stateflow_simulate_worker(&workers[0]);
+
+    /*等待所有线程结束，创建失败的线程的任务在调用线程中执行*/
+    for (uint8_t w = 1; w < number_of_workers; w++)
+    {
+        if (!is_thread_created[w])
+        {
+            stateflow_simulate_worker(&workers[w]);
+            continue;
+        }
+#ifdef _WIN32
+        WaitForSingleObject(threads[w], INFINITE);
+        CloseHandle(threads[w]);
+#else
+        pthread_join(threads[w], NULL);
+#endif
+    }
+
+    // 返回第一个失败任务的仿真结果
+    for (uint16_t j = 0; j < number_of_jobs; j++)
+    {
+        if (jobs[j].status != OK)
+            return jobs[j].status;
+    }
+
+    return OK;
+}
+
+/**
+ * @name    SSF_SimulateResultWrite
+ * @brief   write transition records into a result file
+ * @param file              file opened in binary write mode
+ * @param records           start address of transition records
+ * @param number_of_records the number of transition records
+ * @return  stateflow_error
+ * @example SSF_SimulateResultWrite(result_file, test_records, test_record_count);
+ * @note    Records are written as is in native byte order, 8 bytes each, and can be appended in several calls.
+ */
+/**
+ * @name    SSF_SimulateResultWrite
+ * @brief   将状态切换记录写入结果文件
+ * @param file              以二进制写方式打开的文件
+ * @param records           状态切换记录首地址
+ * @param number_of_records 状态切换记录数
+ * @return  stateflow_error
+ * @example SSF_SimulateResultWrite(result_file, test_records, test_record_count);
+ * @note    记录按本机字节序原样连续写入，每条8字节，可分多次追加写入。
+ */
+stateflow_error SSF_SimulateResultWrite(FILE *file, const stateflow_transition_record_s_t *records,
+                                        uint32_t number_of_records)
+{
+    // 参数检查
+    if ((file == NULL) || ((records == NULL) && (number_of_records > 0)))
+        return STATEFLOW_SIMULATE_INPUT_ERROR;
+
+    if ((number_of_records > 0) &&
+        (fwrite(records, sizeof(stateflow_transition_record_s_t), number_of_records, file) != number_of_records))
+        return STATEFLOW_SIMULATE_FILE_ERROR;
+
+    return OK;
+}
+
+/**
+ * @name    stateflow_simulate_align
+ * @brief   round a byte count up to the column alignment of input log files
+ * @param   size    byte count
+ * @return  aligned byte count
+ * @note    Simulate internal call
+ */
+/**
+ * @name    stateflow_simulate_align
+ * @brief   将字节数向上对齐到输入记录文件的列对齐字节数
+ * @param   size    字节数
+ * @return  对齐后的字节数
+ * @note    仿真内部调用
+ */
+static uint64_t stateflow_simulate_align(uint64_t size)
+{
+    return (size + SSF_SIMULATE_LOG_ALIGN - 1) / SSF_SIMULATE_LOG_ALIGN * SSF_SIMULATE_LOG_ALIGN;
+}
+
+/**
+ * @name    stateflow_simulate_worker
+ * @brief   run the simulation jobs assigned to one worker
+ * @param   worker  worker parameter structure pointer
+ * @return  void
+ * @note    Simulate internal call
+ */
+/**
+ * @name    stateflow_simulate_worker
+ * @brief   执行分配给一个线程的仿真任务
+ * @param   worker  线程参数结构体地址
+ * @return  void
+ * @note    仿真内部调用
+ */
+static void stateflow_simulate_worker(stateflow_simulate_worker_s_t *worker)
+{
+    for (uint32_t j = worker->worker_index; j < worker->number_of_jobs; j += worker->number_of_workers)
+    {
+        stateflow_simulate_job_s_t *job = &worker->jobs[j];
+
+        job->number_of_records = 0;
+        job->number_of_ticks_processed = 0;
+        job->status = SSF_Simulate(job->stateflow, job->log, worker->fields, worker->number_of_fields,
+                                   job->first_tick, job->output, job->output_size, &job->number_of_records,
+                                   &job->number_of_ticks_processed);
+    }
+}
+
+/**
+ * @name    stateflow_simulate_thread
+ * @brief   thread entry of a batch simulation worker
+ * @param   worker  worker parameter structure pointer
+ * @return  0 / NULL
+ * @note    Simulate internal call
+ */
+/**
+ * @name    stateflow_simulate_thread
+ * @brief   批量仿真线程入口
+ * @param   worker  线程参数结构体地址
+ * @return  0 / NULL
+ * @note    仿真内部调用
+ */
+#ifdef _WIN32
+static DWORD WINAPI stateflow_simulate_thread(LPVOID worker)
+{
+    stateflow_simulate_worker((stateflow_simulate_worker_s_t *)worker);
+    return 0;
+}
+#else
+static void *stateflow_simulate_thread(void *worker)
+{
+    stateflow_simulate_worker((stateflow_simulate_worker_s_t *)worker);
+    return NULL;
+}
+#endif
@@ -0,0 +1,192 @@
+/**
+ ******************************************************************************
+ * @file    simple_stateflow_simulate.c/h
+ * @author  Enoky Bertram form Earth
+ * @version V2.2.0
+ * @date    Oct.19.2026
+ * @brief   Offline Simulation of Simple State Flow /简易状态切换器离线仿真
+ * @note    仅用于PC等有文件系统的平台，嵌入式平台无需编译此文件
+ ******************************************************************************
+ */
+
+#ifndef __STATEFLOW_SIMULATE_H_
+#define __STATEFLOW_SIMULATE_H_
+
+#include <stddef.h>
+
+#include "simple_stateflow.h"
+
+/**
+ * 输入记录文件格式(列存储，本机字节序):
+ *  偏移0   uint32_t 文件标识 SSF_SIMULATE_LOG_MAGIC
+ *  偏移4   uint16_t 列数
+ *  偏移6   uint16_t 保留，为0
+ *  偏移8   uint32_t 步进周期数
+ *  偏移12  uint32_t 保留，为0
+ *  偏移16  uint16_t 每列单个数据的字节数，共列数个
+ *  之后    各列依次存放，每列起始按8字节对齐，每列包含步进周期数个数据
+ */
+#define SSF_SIMULATE_LOG_MAGIC 0x4C465353 // 输入记录文件标识"SSFL"
+#define SSF_SIMULATE_LOG_ALIGN 8          // 输入记录文件中各列的对齐字节数
+
+#define SSF_SIMULATE_MAX_COLUMNS 32 // 输入记录最大列数
+#define SSF_SIMULATE_MAX_THREADS 64 // 批量仿真最大线程数
+
+/**
+ * @brief 状态机 离线仿真信箱字段描述结构体，描述输入记录的一列对应的信箱字段
+ */
+typedef struct StateFlowSimulateField
+{
+    uint16_t offset; // 字段在状态机信箱中的偏移
+    uint16_t size;   // 字段字节数
+} stateflow_simulate_field_s_t;
+
+// 由信箱字段名生成字段描述
+#define SSF_SIMULATE_FIELD(field)                                                                              \
+    {offsetof(stateflow_message_box_s_t, field), sizeof(((stateflow_message_box_s_t *)0)->field)}
+
+/**
+ * @brief 状态机 离线仿真输入记录结构体
+ */
+typedef struct StateFlowSimulateLog
+{
+    const void *columns[SSF_SIMULATE_MAX_COLUMNS];  // 各列数据首地址，直接指向映射的文件内容
+    uint16_t column_size[SSF_SIMULATE_MAX_COLUMNS]; // 各列单个数据的字节数
+    uint16_t number_of_columns;                     // 列数
+    uint32_t number_of_ticks;                       // 步进周期数
+
+    const void *map_address; // 文件映射首地址，不是由SSF_SimulateLogMap打开时为NULL
+    size_t map_size;         // 文件映射字节数
+} stateflow_simulate_log_s_t;
+
+/**
+ * @brief 状态机 离线仿真状态切换记录结构体，结果文件即此结构体的连续存放
+ */
+typedef struct StateFlowTransitionRecord
+{
+    uint32_t tick;       // 发生切换的步进周期在输入记录中的序号
+    uint16_t from_state; // 切换前的状态
+    uint16_t to_state;   // 切换后的状态
+} stateflow_transition_record_s_t;
+
+/**
+ * @brief 状态机 批量离线仿真任务结构体
+ */
+typedef struct StateFlowSimulateJob
+{
+    /*任务设置*/
+    stateflow_s_t *stateflow;                // 状态机结构体地址
+    const stateflow_simulate_log_s_t *log;   // 输入记录
+    uint32_t first_tick;                     // 起始步进周期序号
+    stateflow_transition_record_s_t *output; // 状态切换记录输出缓冲区首地址
+    uint32_t output_size;                    // 状态切换记录输出缓冲区可容纳的记录数
+
+    /*任务结果*/
+    stateflow_error status;             // 仿真结果
+    uint32_t number_of_records;         // 已写入的状态切换记录数
+    uint32_t number_of_ticks_processed; // 已执行的步进周期数
+} stateflow_simulate_job_s_t;
+
+/**
+ * @name    SSF_SimulateLogOpen
+ * @brief   由内存中的输入记录文件内容打开输入记录
+ * @param log   输入记录结构体地址
+ * @param data  输入记录文件内容首地址
+ * @param size  输入记录文件内容字节数
+ * @return  stateflow_error
+ * @example SSF_SimulateLogOpen(&test_log, log_data, log_size);
+ * @note    各列直接指向data内的数据，不做任何拷贝，data在输入记录使用期间须保持有效。
+ */
+stateflow_error SSF_SimulateLogOpen(stateflow_simulate_log_s_t *log, const void *data, size_t size);
+
+/**
+ * @name    SSF_SimulateLogMap
+ * @brief   将输入记录文件映射到内存并打开输入记录
+ * @param log   输入记录结构体地址
+ * @param path  输入记录文件路径
+ * @return  stateflow_error
+ * @example SSF_SimulateLogMap(&test_log, "test_log.ssf");
+ * @note    使用完毕后须调用SSF_SimulateLogUnmap。
+ */
+stateflow_error SSF_SimulateLogMap(stateflow_simulate_log_s_t *log, const char *path);
+
+/**
+ * @name    SSF_SimulateLogUnmap
+ * @brief   解除输入记录文件的内存映射
+ * @param log   输入记录结构体地址
+ * @return  void
+ * @example SSF_SimulateLogUnmap(&test_log);
+ * @note    无
+ */
+void SSF_SimulateLogUnmap(stateflow_simulate_log_s_t *log);
+
+/**
+ * @name    SSF_SimulateLogWrite
+ * @brief   将按列存放的数据写为输入记录文件
+ * @param file              以二进制写方式打开的文件
+ * @param columns           各列数据首地址
+ * @param column_size       各列单个数据的字节数
+ * @param number_of_columns 列数
+ * @param number_of_ticks   步进周期数
+ * @return  stateflow_error
+ * @example SSF_SimulateLogWrite(log_file, test_columns, test_column_size, 1, 10);
+ * @note    供数据录制程序生成输入记录文件。
+ */
+stateflow_error SSF_SimulateLogWrite(FILE *file, const void *const *columns, const uint16_t *column_size,
+                                     uint16_t number_of_columns, uint32_t number_of_ticks);
+
+/**
+ * @name    SSF_Simulate
+ * @brief   以输入记录离线仿真状态机
+ * @param stateflow                 状态机结构体地址
+ * @param log                       输入记录
+ * @param fields                    输入记录各列对应的信箱字段描述，第k个描述对应第k列
+ * @param number_of_fields          信箱字段描述数量，不大于输入记录列数
+ * @param first_tick                起始步进周期序号
+ * @param output                    状态切换记录输出缓冲区首地址
+ * @param output_size               状态切换记录输出缓冲区可容纳的记录数
+ * @param number_of_records         已写入的状态切换记录数
+ * @param number_of_ticks_processed 已执行的步进周期数
+ * @return  stateflow_error
+ * @example SSF_Simulate(&test_state_flow, &test_log, test_fields, 1, 0, test_records, 1024, &test_record_count,
+ *                       &test_tick_count);
+ * @note    每个步进周期先将各列数据拷入对应的信箱字段，再执行一个步进周期，不做任何实时节拍控制。
+ *          输出缓冲区写满且仍有未执行的步进周期时，仿真停止并返回STATEFLOW_SIMULATE_OUTPUT_FULL_ERROR，
+ *          此时已执行的步进周期中的所有切换均已被记录，以first_tick + number_of_ticks_processed为起始序号继续仿真即可。
+ */
+stateflow_error SSF_Simulate(stateflow_s_t *stateflow, const stateflow_simulate_log_s_t *log,
+                             const stateflow_simulate_field_s_t *fields, uint16_t number_of_fields,
+                             uint32_t first_tick, stateflow_transition_record_s_t *output, uint32_t output_size,
+                             uint32_t *number_of_records, uint32_t *number_of_ticks_processed);
+
+/**
+ * @name    SSF_SimulateBatch
+ * @brief   多线程批量离线仿真多个状态机
+ * @param jobs              仿真任务数组首地址
+ * @param number_of_jobs    仿真任务数量
+ * @param fields            输入记录各列对应的信箱字段描述，所有任务共用
+ * @param number_of_fields  信箱字段描述数量
+ * @param number_of_threads 线程数，为0或1时在调用线程中依次执行
+ * @return  stateflow_error 第一个失败任务的仿真结果，全部成功时为OK
+ * @example SSF_SimulateBatch(test_jobs, 2, test_fields, 1, 2);
+ * @note    各任务的状态机须互不相同，检测方法及状态方法会在多个线程中同时被调用，不可使用无保护的全局数据。
+ *          线程创建失败时，该线程的任务改在调用线程中执行。
+ */
+stateflow_error SSF_SimulateBatch(stateflow_simulate_job_s_t *jobs, uint16_t number_of_jobs,
+                                  const stateflow_simulate_field_s_t *fields, uint16_t number_of_fields,
+                                  uint8_t number_of_threads);
+
+/**
+ * @name    SSF_SimulateResultWrite
+ * @brief   将状态切换记录写入结果文件
+ * @param file              以二进制写方式打开的文件
+ * @param records           状态切换记录首地址
+ * @param number_of_records 状态切换记录数
+ * @return  stateflow_error
+ * @example SSF_SimulateResultWrite(result_file, test_records, test_record_count);
+ * @note    记录按本机字节序原样连续写入，每条8字节，可分多次追加写入。
+ */
+stateflow_error SSF_SimulateResultWrite(FILE *file, const stateflow_transition_record_s_t *records,
+                                        uint32_t number_of_records);
+
+#endif /* __STATEFLOW_SIMULATE_H_ */